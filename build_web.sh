@@ -1,34 +1,105 @@
 #!/bin/bash
 
+# Usage: ./build_web.sh [--simd] [--threads] [--bench]
+#   --simd     build the sim kernels with -msimd128
+#   --threads  run the sim in a pthread worker (needs SharedArrayBuffer, so the
+#              page must be served with COOP/COEP headers: python3 serve_web.py)
+#   --bench    build the headless benchmark for node instead of the app, then run it
+
 # Configuration
 MAIN_SRC="src/main.cpp"
 PLAYER_SRC="src/player/player.cpp"
 USEIMGUI_SRC="src/UseImGui.cpp"
+SIM_SRCS="src/sim/arena.cpp src/sim/sim_worker.cpp"
+BENCH_SRC="src/bench.cpp"
 IMGUI_CORE_SRCS="imgui/imgui.cpp imgui/imgui_draw.cpp imgui/imgui_widgets.cpp imgui/imgui_tables.cpp imgui/imgui_demo.cpp"
 IMGUI_BACKENDS_SRCS="imgui/backends/imgui_impl_glfw.cpp imgui/backends/imgui_impl_opengl3.cpp"
-INCLUDES="-Iimgui -Iimgui/backends"
+INCLUDES="-Isrc -Iimgui -Iimgui/backends"
 OUTPUT_FILE="index.html"
+BENCH_OUTPUT_FILE="bench.js"
+SIM_THREADS=2 # sizes the pthread pool and is passed to main.cpp as APEX_SIM_THREADS
+BENCH_ARGS="--arenas 1024 --steps 2000"
+BENCH_CHECKSUM="bc588a9ccae54000" # same golden value as the APEX_bench CTest
+
+SIMD=0
+THREADS=0
+BENCH=0
+for arg in "$@"; do
+    case $arg in
+        --simd) SIMD=1 ;;
+        --threads) THREADS=1 ;;
+        --bench) BENCH=1 ;;
+        *) echo "Unknown option: $arg"; exit 1 ;;
+    esac
+done
+
+FLAGS="-std=c++17 -O2 -DAPEX_SIM_THREADS=$SIM_THREADS"
+if [ $SIMD -eq 1 ]; then
+    FLAGS="$FLAGS -msimd128"
+fi
+if [ $THREADS -eq 1 ]; then
+    # Growable shared memory slows every JS heap access, so threaded builds get
+    # a fixed heap instead of ALLOW_MEMORY_GROWTH
+    FLAGS="$FLAGS -pthread -s PTHREAD_POOL_SIZE=$SIM_THREADS"
+    MEMORY_FLAGS="-s INITIAL_MEMORY=64MB"
+else
+    MEMORY_FLAGS="-s ALLOW_MEMORY_GROWTH=1"
+fi
 
 echo "Starting Emscripten compilation..."
 
+if [ $BENCH -eq 1 ]; then
+    # Headless: no GL or DOM, runs under node
+    emcc \
+        $BENCH_SRC \
+        $SIM_SRCS \
+        $INCLUDES \
+        $FLAGS \
+        -s ENVIRONMENT=node$( [ $THREADS -eq 1 ] && echo ",worker" ) \
+        -s EXIT_RUNTIME=1 \
+        -o $BENCH_OUTPUT_FILE
+
+    if [ $? -ne 0 ]; then
+        echo "Compilation failed."
+        exit 1
+    fi
+    echo "Compilation successful. Running benchmark..."
+    if [ $THREADS -eq 1 ]; then
+        BENCH_ARGS="$BENCH_ARGS --threads $SIM_THREADS"
+    fi
+    # Fails if this build's kernel or threading diverges from the native result
+    node $BENCH_OUTPUT_FILE $BENCH_ARGS --expect $BENCH_CHECKSUM
+    if [ $? -ne 0 ]; then
+        echo "Benchmark failed."
+        exit 1
+    fi
+    exit 0
+fi
+
 # Execute the compilation command
 emcc \
     $MAIN_SRC \
     $PLAYER_SRC \
     $USEIMGUI_SRC \
+    $SIM_SRCS \
     $IMGUI_CORE_SRCS \
     $IMGUI_BACKENDS_SRCS \
     $INCLUDES \
+    $FLAGS \
     -s USE_GLFW=3 \
     -s USE_WEBGL2=1 \
-    -s ALLOW_MEMORY_GROWTH=1 \
+    $MEMORY_FLAGS \
     -s GL_ASSERTIONS=1 \
     --no-entry \
     -o $OUTPUT_FILE
 
 if [ $? -eq 0 ]; then
     echo "Compilation successful. Output files generated: index.html, index.wasm, index.js"
-    echo "To run, you must use a local web server (e.g., python3 -m http.server)."
+    if [ $THREADS -eq 1 ]; then
+        echo "To run, serve with cross-origin isolation headers: python3 serve_web.py"
+    else
+        echo "To run, you must use a local web server (e.g., python3 -m http.server)."
+    fi
 else
     echo "Compilation failed."
 fi
@@ -0,0 +1,12 @@
+# Static file server for the web build. Threaded builds use SharedArrayBuffer,
+# which browsers only expose on cross-origin isolated pages.
+import http.server
+
+class IsolatedHandler(http.server.SimpleHTTPRequestHandler):
+    def end_headers(self):
+        self.send_header("Cross-Origin-Opener-Policy", "same-origin")
+        self.send_header("Cross-Origin-Embedder-Policy", "require-corp")
+        super().end_headers()
+
+if __name__ == "__main__":
+    http.server.test(HandlerClass=IsolatedHandler, port=8000)
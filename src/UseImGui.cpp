@@ -1,5 +1,4 @@
 #include "UseImGui.hpp"
-#include <cstdlib>
 
 void UseImGui::init(GLFWwindow *window)
 {
@@ -32,18 +31,14 @@ void render_player(ImDrawList *draw_list, Player *player)
   draw_list->AddCircleFilled(ImVec2(static_cast<float>(pos.first), static_cast<float>(pos.second)), playerSize, playerColour, 20);
 }
 
-void UseImGui::update(Player *players)
+void UseImGui::update(Player *players, const SimWorker &sim)
 {
   ImGui::Begin("Apex Multi-agent Reinforcement Learning Arena");
+  ImGui::Text("%d arenas on %d sim thread(s), %llu arena steps", sim.arenaCount(), sim.threadCount(),
+              static_cast<unsigned long long>(sim.totalSteps()));
   ImDrawList *draw_list = ImGui::GetWindowDrawList();
   for (int i = 0; i < 10; ++i)
-  {
     render_player(draw_list, &players[i]);
-    int dx = (rand() % 11) - 5; // random step between -5 and 5
-    int dy = (rand() % 11) - 5;
-    auto pos = players[i].getPosition();
-    players[i].move(pos.first + dx, pos.second + dy);
-  }
   ImGui::End();
 }
 
@@ -5,13 +5,14 @@
 #include <imgui_impl_glfw.h>
 #include "imgui_impl_opengl3.h"
 #include "player/player.hpp"
+#include "sim/sim_worker.hpp"
 
 class UseImGui
 {
 public:
   void init(GLFWwindow *window);
   void newFrame();
-  virtual void update(Player *players);
+  virtual void update(Player *players, const SimWorker &sim);
   void render();
   void shutdown();
 };
@@ -0,0 +1,90 @@
+// Headless throughput benchmark for the arena sim. Builds natively and for
+// node (see build_web.sh --bench) so the WASM path can be measured without a
+// browser. --expect turns a run into a test: it fails unless the checksum
+// matches, which is how the SIMD and threaded builds are checked against the
+// scalar one.
+#include "sim/sim_worker.hpp"
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <climits>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+static int usage(const char *argv0)
+{
+  std::fprintf(stderr, "usage: %s [--arenas N] [--steps N] [--threads N] [--expect CHECKSUM]\n", argv0);
+  return 1;
+}
+
+// Parses a positive int, rejecting trailing junk and out-of-range values.
+static bool parse_count(const char *text, int &out)
+{
+  char *end = nullptr;
+  errno = 0;
+  long value = std::strtol(text, &end, 10);
+  if (errno || end == text || *end || value < 1 || value > INT_MAX)
+    return false;
+  out = static_cast<int>(value);
+  return true;
+}
+
+int main(int argc, char **argv)
+{
+  int arena_count = 1024;
+  int steps = 2000;
+  int thread_count = 1;
+  bool check = false;
+  unsigned long long expected = 0;
+  for (int i = 1; i < argc; i += 2)
+  {
+    if (i + 1 >= argc)
+      return usage(argv[0]);
+    const char *value = argv[i + 1];
+    bool ok;
+    if (!std::strcmp(argv[i], "--arenas"))
+      ok = parse_count(value, arena_count);
+    else if (!std::strcmp(argv[i], "--steps"))
+      ok = parse_count(value, steps);
+    else if (!std::strcmp(argv[i], "--threads"))
+      ok = parse_count(value, thread_count);
+    else if (!std::strcmp(argv[i], "--expect"))
+    {
+      char *end = nullptr;
+      errno = 0;
+      expected = std::strtoull(value, &end, 16);
+      ok = check = !errno && end != value && !*end;
+    }
+    else
+      ok = false;
+    if (!ok)
+      return usage(argv[0]);
+  }
+
+  SimWorker worker(arena_count, thread_count);
+  auto start = std::chrono::steady_clock::now();
+  worker.runBlocking(steps);
+  std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+  // Guards the rates below against a run too short for the clock to tick
+  double seconds = std::max(elapsed.count(), 1e-9);
+
+  double arena_steps = static_cast<double>(worker.totalSteps());
+#ifdef __wasm_simd128__
+  const char *kernel = "simd128";
+#else
+  const char *kernel = "scalar";
+#endif
+  std::printf("kernel=%s arenas=%d threads=%d steps=%d\n", kernel, worker.arenaCount(),
+              worker.threadCount(), steps);
+  std::printf("%.3f s, %.0f arena-steps/s, %.0f player-steps/s\n", seconds,
+              arena_steps / seconds, arena_steps * Arena::kPlayers / seconds);
+  unsigned long long checksum = worker.checksum();
+  std::printf("checksum=%016llx\n", checksum);
+  if (check && checksum != expected)
+  {
+    std::fprintf(stderr, "checksum mismatch: expected %016llx\n", expected);
+    return 1;
+  }
+  return 0;
+}
@@ -2,6 +2,7 @@
 #include "imgui_impl_glfw.h"
 #include "imgui_impl_opengl3.h"
 #include "player/player.hpp"
+#include "sim/sim_worker.hpp"
 #include <GL/glew.h>
 #include <GLFW/glfw3.h>
 #include <cstdio>
@@ -15,6 +16,17 @@ GLFWwindow *window = nullptr;
 UseImGui myimgui;
 Player players[10];
 
+// Arena 0 is the one drawn; the rest keep the sim threads busy for demos.
+// APEX_SIM_THREADS comes from the build so the web build's pthread pool is
+// sized to match; a browser main thread can't wait for new workers to spawn.
+#ifndef APEX_SIM_THREADS
+#define APEX_SIM_THREADS 2
+#endif
+constexpr int kSimArenas = 64;
+constexpr int kSimThreads = APEX_SIM_THREADS;
+constexpr int kSimTicksPerSecond = 60;
+SimWorker sim(kSimArenas, kSimThreads);
+
 void main_loop(void *arg)
 {
   // Checks for key bindings and mouse clicks
@@ -22,8 +34,15 @@ void main_loop(void *arg)
   glClearColor(0.45f, 0.55f, 0.60f, 1.00f);
 
   glClear(GL_COLOR_BUFFER_BIT);
+
+  // Without pthreads the sim has no worker to run on, so step it here
+  sim.pump();
+  Arena arena = sim.snapshot();
+  for (int i = 0; i < Arena::kPlayers; ++i)
+    players[i].move(arena.x(i), arena.y(i));
+
   myimgui.newFrame();
-  myimgui.update(players);
+  myimgui.update(players, sim);
   myimgui.render();
   glfwSwapBuffers(window);
 }
@@ -59,6 +78,8 @@ int main()
   players[8] = Player('b', true);
   players[9] = Player('b', true);
 
+  sim.start(kSimTicksPerSecond);
+
 // Desktop loop (retains original behavior for non-Emscripten compilation)
 #ifdef __EMSCRIPTEN__
   // Use Emscripten's main loop management for web compatibility
@@ -71,6 +92,7 @@ int main()
   };
 #endif
 
+sim.stop();
 myimgui.shutdown();
 return 0;
 }
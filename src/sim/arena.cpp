@@ -0,0 +1,107 @@
+#include "arena.hpp"
+#include <cstring>
+
+#ifdef __wasm_simd128__
+#include <wasm_simd128.h>
+#endif
+
+Arena::Arena() : Arena(1) {}
+
+Arena::Arena(std::uint32_t seed)
+{
+  for (int i = 0; i < kLanes; ++i)
+  {
+    xs[i] = 500.0f;
+    ys[i] = 500.0f;
+    // xorshift32 must never be seeded with zero
+    std::uint32_t s = seed * 2654435761u + static_cast<std::uint32_t>(i) * 40503u;
+    rng[i] = s ? s : 0x9e3779b9u;
+  }
+}
+
+#ifdef __wasm_simd128__
+
+static inline v128_t next_rng(v128_t s)
+{
+  s = wasm_v128_xor(s, wasm_i32x4_shl(s, 13));
+  s = wasm_v128_xor(s, wasm_u32x4_shr(s, 17));
+  return wasm_v128_xor(s, wasm_i32x4_shl(s, 5));
+}
+
+// Maps the top 16 bits of the state onto -5..5 without a division.
+static inline v128_t rng_to_step(v128_t s)
+{
+  v128_t r = wasm_i32x4_mul(wasm_u32x4_shr(s, 16), wasm_i32x4_splat(11));
+  return wasm_f32x4_convert_i32x4(wasm_i32x4_sub(wasm_u32x4_shr(r, 16), wasm_i32x4_splat(5)));
+}
+
+// Zeroes any lane outside (0, 1000), same as Player::move.
+static inline v128_t clamp_lane(v128_t v)
+{
+  v128_t inside = wasm_v128_and(wasm_f32x4_gt(v, wasm_f32x4_splat(0.0f)),
+                                wasm_f32x4_lt(v, wasm_f32x4_splat(1000.0f)));
+  return wasm_v128_and(v, inside);
+}
+
+void Arena::step()
+{
+  for (int i = 0; i < kLanes; i += 4)
+  {
+    v128_t s = next_rng(wasm_v128_load(&rng[i]));
+    v128_t dx = rng_to_step(s);
+    s = next_rng(s);
+    v128_t dy = rng_to_step(s);
+    wasm_v128_store(&rng[i], s);
+    wasm_v128_store(&xs[i], clamp_lane(wasm_f32x4_add(wasm_v128_load(&xs[i]), dx)));
+    wasm_v128_store(&ys[i], clamp_lane(wasm_f32x4_add(wasm_v128_load(&ys[i]), dy)));
+  }
+}
+
+#else
+
+static inline std::uint32_t next_rng(std::uint32_t s)
+{
+  s ^= s << 13;
+  s ^= s >> 17;
+  return s ^ (s << 5);
+}
+
+static inline float rng_to_step(std::uint32_t s)
+{
+  std::uint32_t r = (s >> 16) * 11u;
+  return static_cast<float>(static_cast<std::int32_t>(r >> 16) - 5);
+}
+
+static inline float clamp_lane(float v)
+{
+  return (v > 0.0f && v < 1000.0f) ? v : 0.0f;
+}
+
+void Arena::step()
+{
+  for (int i = 0; i < kLanes; ++i)
+  {
+    std::uint32_t s = next_rng(rng[i]);
+    float dx = rng_to_step(s);
+    s = next_rng(s);
+    float dy = rng_to_step(s);
+    rng[i] = s;
+    xs[i] = clamp_lane(xs[i] + dx);
+    ys[i] = clamp_lane(ys[i] + dy);
+  }
+}
+
+#endif
+
+std::uint64_t Arena::checksum() const
+{
+  std::uint64_t sum = 0;
+  for (int i = 0; i < kPlayers; ++i)
+  {
+    std::uint32_t bx, by;
+    std::memcpy(&bx, &xs[i], sizeof bx);
+    std::memcpy(&by, &ys[i], sizeof by);
+    sum += (static_cast<std::uint64_t>(bx) << 32) ^ by;
+  }
+  return sum;
+}
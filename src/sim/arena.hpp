@@ -0,0 +1,33 @@
+#ifndef ARENA_HPP
+#define ARENA_HPP
+
+#include <cstdint>
+
+// One bout's worth of skaters laid out as structure-of-arrays so step() can be
+// vectorised. Built with -msimd128 it uses wasm SIMD; otherwise it runs the
+// same arithmetic one lane at a time, so both builds produce identical
+// positions for the same seed.
+class Arena
+{
+public:
+  static constexpr int kPlayers = 10;
+  // Rounded up to a multiple of four lanes; the padding lanes are simulated
+  // but never read back.
+  static constexpr int kLanes = 12;
+
+  Arena();
+  explicit Arena(std::uint32_t seed);
+  // Random walk of -5..5 per axis, matching Player::move's bounds handling.
+  void step();
+  float x(int i) const { return xs[i]; }
+  float y(int i) const { return ys[i]; }
+  // Order-independent digest of positions, used to compare builds.
+  std::uint64_t checksum() const;
+
+private:
+  alignas(16) float xs[kLanes];
+  alignas(16) float ys[kLanes];
+  alignas(16) std::uint32_t rng[kLanes];
+};
+
+#endif
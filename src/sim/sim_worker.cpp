@@ -0,0 +1,138 @@
+#include "sim_worker.hpp"
+#include <algorithm>
+#include <cmath>
+
+#if defined(__EMSCRIPTEN__) && !defined(__EMSCRIPTEN_PTHREADS__)
+#define APEX_SIM_HAS_THREADS 0
+#else
+#define APEX_SIM_HAS_THREADS 1
+#endif
+
+SimWorker::SimWorker(int arena_count, int requested_threads)
+{
+  arena_count = std::max(arena_count, 1);
+  arenas.reserve(arena_count);
+  for (int i = 0; i < arena_count; ++i)
+    arenas.emplace_back(static_cast<std::uint32_t>(i + 1));
+  thread_count = APEX_SIM_HAS_THREADS ? std::clamp(requested_threads, 1, arena_count) : 1;
+  published = arenas[0];
+}
+
+SimWorker::~SimWorker() { stop(); }
+
+void SimWorker::stepSlice(int thread_index, int steps)
+{
+  if (steps <= 0)
+    return;
+  const int count = arenaCount();
+  const int begin = count * thread_index / thread_count;
+  const int end = count * (thread_index + 1) / thread_count;
+  for (int s = 0; s < steps; ++s)
+    for (int a = begin; a < end; ++a)
+      arenas[a].step();
+  steps_done.fetch_add(static_cast<std::uint64_t>(steps) * (end - begin), std::memory_order_relaxed);
+}
+
+// Only called by whichever thread owns arena 0.
+void SimWorker::publish()
+{
+  std::lock_guard<std::mutex> lock(snapshot_mutex);
+  published = arenas[0];
+}
+
+void SimWorker::runBlocking(int steps)
+{
+  if (steps <= 0)
+    return;
+#if APEX_SIM_HAS_THREADS
+  std::vector<std::thread> pool;
+  for (int t = 1; t < thread_count; ++t)
+    pool.emplace_back(&SimWorker::stepSlice, this, t, steps);
+  stepSlice(0, steps);
+  for (auto &thread : pool)
+    thread.join();
+#else
+  stepSlice(0, steps);
+#endif
+  publish();
+}
+
+void SimWorker::runLoop(int thread_index)
+{
+  using clock = std::chrono::steady_clock;
+  const auto period = tick_rate > 0 ? std::chrono::nanoseconds(1000000000 / tick_rate)
+                                    : std::chrono::nanoseconds(0);
+  auto next_tick = clock::now();
+  while (running.load(std::memory_order_relaxed))
+  {
+    stepSlice(thread_index, 1);
+    if (thread_index == 0)
+      publish();
+    if (tick_rate > 0)
+    {
+      next_tick += period;
+      // After a stall (throttled tab, suspend) resume from now rather than
+      // bursting through the missed ticks
+      auto now = clock::now();
+      if (next_tick < now)
+        next_tick = now;
+      std::this_thread::sleep_until(next_tick);
+    }
+  }
+}
+
+void SimWorker::start(int ticks_per_second)
+{
+  tick_rate = ticks_per_second;
+  last_pump = std::chrono::steady_clock::now();
+  pending_ticks = 0.0;
+#if APEX_SIM_HAS_THREADS
+  if (running.exchange(true))
+    return;
+  for (int t = 0; t < thread_count; ++t)
+    threads.emplace_back(&SimWorker::runLoop, this, t);
+#endif
+}
+
+void SimWorker::stop()
+{
+  running = false;
+  for (auto &thread : threads)
+    thread.join();
+  threads.clear();
+}
+
+void SimWorker::pump()
+{
+  if (running)
+    return;
+  int steps = 1;
+  if (tick_rate > 0)
+  {
+    auto now = std::chrono::steady_clock::now();
+    std::chrono::duration<double> elapsed = now - last_pump;
+    last_pump = now;
+    // Capped at one second's worth so a paused tab doesn't resume in a burst
+    pending_ticks = std::min(pending_ticks + elapsed.count() * tick_rate, static_cast<double>(tick_rate));
+    steps = static_cast<int>(std::floor(pending_ticks));
+    pending_ticks -= steps;
+  }
+  for (int t = 0; t < thread_count; ++t)
+    stepSlice(t, steps);
+  if (steps > 0)
+    publish();
+}
+
+Arena SimWorker::snapshot()
+{
+  std::lock_guard<std::mutex> lock(snapshot_mutex);
+  return published;
+}
+
+std::uint64_t SimWorker::checksum() const
+{
+  std::uint64_t sum = 0;
+  for (const auto &arena : arenas)
+    sum += arena.checksum();
+  return sum;
+}
@@ -0,0 +1,57 @@
+#ifndef SIM_WORKER_HPP
+#define SIM_WORKER_HPP
+
+#include "arena.hpp"
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Steps a batch of arenas off the render thread. Arenas are split into
+// contiguous slices, one per thread, so threads never share an arena. On an
+// Emscripten build without -pthread there are no threads to spawn, and pump()
+// steps everything on the caller's thread instead.
+class SimWorker
+{
+public:
+  SimWorker(int arena_count, int thread_count);
+  ~SimWorker();
+
+  // Runs every arena 'steps' times and returns once all threads are done.
+  void runBlocking(int steps);
+  // Starts free-running at 'ticks_per_second' per arena (0 = unthrottled).
+  void start(int ticks_per_second);
+  void stop();
+  // Single-threaded fallback; a no-op while the worker threads are running.
+  // Steps as many ticks as wall-clock time since the last call allows, so the
+  // sim runs at the same rate regardless of how often it is called.
+  void pump();
+
+  // Copy of arena 0 as of its last completed step, safe to call from the
+  // render thread.
+  Arena snapshot();
+  std::uint64_t totalSteps() const { return steps_done.load(std::memory_order_relaxed); }
+  std::uint64_t checksum() const;
+  int arenaCount() const { return static_cast<int>(arenas.size()); }
+  int threadCount() const { return thread_count; }
+
+private:
+  void stepSlice(int thread_index, int steps);
+  void publish();
+  void runLoop(int thread_index);
+
+  std::vector<Arena> arenas;
+  int thread_count;
+  std::vector<std::thread> threads;
+  std::atomic<bool> running{false};
+  std::atomic<std::uint64_t> steps_done{0};
+  std::mutex snapshot_mutex;
+  Arena published;
+  int tick_rate = 0;
+  std::chrono::steady_clock::time_point last_pump;
+  double pending_ticks = 0.0;
+};
+
+#endif